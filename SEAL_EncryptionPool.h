@@ -0,0 +1,179 @@
+#ifndef SEAL_ENCRYPTION_POOL_H
+#define SEAL_ENCRYPTION_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "seal/seal.h"
+using namespace seal;
+
+/**
+ * Pool of precomputed public-key encryptions of zero for one parameter set
+ *
+ * A background thread keeps up to `depth` fresh encryptions of zero per registered
+ * level, using idle time between bursts. Online encryption then only encodes and
+ * adds the plaintext to a pooled ciphertext, which is the same computation
+ * Encryptor::encrypt() performs after its internal encrypt_zero(). Every pooled
+ * ciphertext is handed out exactly once. When a level is drained, encryption falls
+ * back to a synchronous encrypt_zero() and the miss is counted. If refilling throws
+ * (e.g. std::bad_alloc on a deep pool), the thread stores the error and stops;
+ * encryption keeps working through the fallback and waitUntilFull() rethrows it.
+ */
+
+class EncryptionPool {
+private:
+    SEALContext context;
+    Encryptor encryptor;
+    Evaluator evaluator;
+    size_t depth;
+
+    std::map<parms_id_type, std::deque<Ciphertext>> levels;
+    size_t misses = 0;
+    bool stopping = false;
+    std::exception_ptr refill_error;
+
+    mutable std::mutex mutex;
+    std::condition_variable refill_cv;  // wakes the refill thread
+    std::condition_variable filled_cv;  // wakes waitUntilFull()
+    std::thread refill_thread;
+
+    // Returns a level below depth, or nullptr if every level is full; caller holds mutex
+    const parms_id_type* findLevelToRefill() const {
+        for (const auto& level : levels) {
+            if (level.second.size() < depth) {
+                return &level.first;
+            }
+        }
+        return nullptr;
+    }
+
+    void refillLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            refill_cv.wait(lock, [this] { return stopping || findLevelToRefill() != nullptr; });
+            if (stopping) {
+                return;
+            }
+            parms_id_type parms_id = *findLevelToRefill();
+
+            try {
+                // Sampling, NTTs and polynomial products run without holding the lock
+                lock.unlock();
+                Ciphertext zero;
+                encryptor.encrypt_zero(parms_id, zero);
+                lock.lock();
+                levels[parms_id].push_back(std::move(zero));
+            } catch (...) {
+                // Escaping the thread would call std::terminate; keep the error for waitUntilFull()
+                if (!lock.owns_lock()) {
+                    lock.lock();
+                }
+                refill_error = std::current_exception();
+                filled_cv.notify_all();
+                return;
+            }
+            if (findLevelToRefill() == nullptr) {
+                filled_cv.notify_all();
+            }
+        }
+    }
+
+public:
+    EncryptionPool(const SEALContext& context, const PublicKey& public_key, size_t depth) :
+        context(context),
+        encryptor(context, public_key),
+        evaluator(context),
+        depth(depth)
+    {
+        if (depth == 0) {
+            throw std::invalid_argument("EncryptionPool: depth must be positive");
+        }
+        levels[context.first_parms_id()];
+        refill_thread = std::thread(&EncryptionPool::refillLoop, this);
+    }
+
+    ~EncryptionPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        refill_cv.notify_all();
+        refill_thread.join();
+    }
+
+    EncryptionPool(const EncryptionPool&) = delete;
+    EncryptionPool& operator=(const EncryptionPool&) = delete;
+
+    // Starts pooling encryptions of zero at parms_id as well (e.g. a lower CKKS level)
+    void addLevel(parms_id_type parms_id) {
+        if (!context.get_context_data(parms_id)) {
+            throw std::invalid_argument("EncryptionPool: parms_id is not valid for this context");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            levels[parms_id];
+        }
+        refill_cv.notify_one();
+    }
+
+    // Blocks until every registered level holds depth ciphertexts; rethrows a refill failure
+    void waitUntilFull() {
+        std::unique_lock<std::mutex> lock(mutex);
+        filled_cv.wait(lock, [this] { return refill_error || findLevelToRefill() == nullptr; });
+        if (refill_error) {
+            std::rethrow_exception(refill_error);
+        }
+    }
+
+    // Moves a fresh encryption of zero at parms_id into destination
+    void takeZero(parms_id_type parms_id, Ciphertext& destination) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto level = levels.find(parms_id);
+            if (level == levels.end()) {
+                throw std::invalid_argument("EncryptionPool: level was not registered with addLevel()");
+            }
+            if (!level->second.empty()) {
+                destination = std::move(level->second.front());
+                level->second.pop_front();
+                refill_cv.notify_one();
+                return;
+            }
+            ++misses;
+        }
+        encryptor.encrypt_zero(parms_id, destination);
+    }
+
+    /**
+     * Encrypts an encoded plaintext using a pooled zero ciphertext. BFV plaintexts are
+     * encrypted at the first level; CKKS plaintexts at their own level and scale.
+     */
+    void encrypt(const Plaintext& plain, Ciphertext& destination) {
+        if (plain.is_ntt_form()) {
+            takeZero(plain.parms_id(), destination);
+            destination.scale() = plain.scale();
+        } else {
+            takeZero(context.first_parms_id(), destination);
+        }
+        evaluator.add_plain_inplace(destination, plain);
+    }
+
+    size_t available(parms_id_type parms_id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto level = levels.find(parms_id);
+        return level == levels.end() ? 0 : level->second.size();
+    }
+
+    size_t missCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+};
+
+#endif
@@ -0,0 +1,625 @@
+#ifndef SEAL_PIR_H
+#define SEAL_PIR_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+#include <utility>
+
+#include "seal/seal.h"
+using namespace seal;
+
+/**
+ * BFV Private Information Retrieval (PIR) server mode using Microsoft SEAL
+ *
+ * The database file is split into BFV plaintexts (two bytes per batching slot),
+ * transformed to NTT form once and cached on disk. The plaintexts form a
+ * rows x cols grid. The client sends a single compressed query ciphertext whose
+ * coefficients mark the wanted row and column; the server expands it obliviously
+ * with Galois keys into one selection ciphertext per row/column, scans the grid
+ * with multiply_plain/add_many and answers with a single ciphertext.
+ */
+
+class SEAL_PIR {
+private:
+    std::ostream& log_stream;
+
+    // Identifies .pirdb cache files written by preprocessDatabase()
+    static constexpr uint64_t cache_magic = 0x3252495041455300ULL;
+
+    // Header words: magic, parms_id (4), db_bytes, record_size, rows, cols, content hash, cache_bytes
+    static constexpr size_t cache_header_words = 11;
+
+    static EncryptionParameters create_pir_parms() {
+        EncryptionParameters parms(scheme_type::bfv);
+        size_t poly_modulus_degree = 8192;
+        parms.set_poly_modulus_degree(poly_modulus_degree);
+        parms.set_coeff_modulus(CoeffModulus::BFVDefault(poly_modulus_degree));
+        parms.set_plain_modulus(PlainModulus::Batching(poly_modulus_degree, 20));
+        return parms;
+    }
+
+    // --- BFV parameters shared by client and server ---
+    EncryptionParameters pir_parms;
+    SEALContext pir_context;
+
+    // --- Client side ---
+    KeyGenerator pir_keygen;
+    SecretKey pir_secret_key;
+    std::optional<Encryptor> pir_encryptor;
+    Decryptor pir_decryptor;
+    BatchEncoder pir_encoder;
+
+    // --- Server side ---
+    Evaluator pir_evaluator;
+    GaloisKeys pir_galois_keys;
+    RelinKeys pir_relin_keys;
+
+public:
+    // Layout of a preprocessed database; plaintext p lives at row p / cols, column p % cols
+    struct Database {
+        std::string db_path;
+        std::string cache_path;
+        size_t db_bytes = 0;
+        size_t record_size = 0;
+        size_t records_per_plaintext = 0;
+        size_t plaintext_bytes = 0;
+        size_t num_records = 0;
+        size_t num_plaintexts = 0;
+        size_t rows = 0;
+        size_t cols = 0;
+        size_t expansion_size = 0; // rows + cols rounded up to a power of two
+        uint64_t content_hash = 0;
+        size_t cache_bytes = 0;
+    };
+
+    SEAL_PIR(std::ostream& output_stream) :
+        log_stream(output_stream),
+        pir_parms(create_pir_parms()),
+        pir_context(pir_parms),
+        pir_keygen(pir_context),
+        pir_secret_key(pir_keygen.secret_key()),
+        pir_decryptor(pir_context, pir_secret_key),
+        pir_encoder(pir_context),
+        pir_evaluator(pir_context),
+        pir_galois_keys(),
+        pir_relin_keys()
+    {
+        log_stream << "SEAL_PIR: BFV private information retrieval over a packed database" << std::endl;
+
+        // Queries are encrypted symmetrically so the serialized ciphertext only carries a seed for c1
+        pir_encryptor.emplace(pir_context, pir_secret_key);
+    }
+
+    /**
+     * Computes the layout for db_path and builds the NTT-form plaintext cache next to it.
+     * An existing cache is reused if its header matches the current parameters, the file
+     * contents and the cache length. The cache is built in a temporary file and renamed into
+     * place only once it is complete, so an interrupted run never leaves a valid-looking cache.
+     */
+    Database preprocessDatabase(const std::string& db_path, size_t record_size) {
+        Database db = computeLayout(db_path, record_size);
+        db.content_hash = hashFile(db.db_path);
+
+        if (loadCacheHeader(db)) {
+            log_stream << "   Reusing preprocessed cache " << db.cache_path << std::endl;
+            return db;
+        }
+
+        log_stream << "   Preprocessing " << db.db_path << " -> " << db.cache_path << std::endl;
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::string tmp_path = db.cache_path + ".tmp";
+        std::ifstream in(db.db_path, std::ios::binary);
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+
+        // Any failure (SEAL, std::bad_alloc, I/O) must not leave a partial temporary file behind
+        try {
+            if (!in.is_open() || !out.is_open()) {
+                throw std::runtime_error("SEAL_PIR: could not open " + db.db_path + " or " + tmp_path);
+            }
+
+            // Placeholder header; the real one, including the final length, is written last
+            std::vector<uint64_t> header(cache_header_words, 0);
+            out.write(reinterpret_cast<const char*>(header.data()),
+                      static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+
+            // Column-major order so the server can stream one column at a time during a scan
+            // Sized to the full slot capacity; bytes past plaintext_bytes stay zero
+            std::vector<unsigned char> bytes(pir_encoder.slot_count() * 2);
+            std::vector<uint64_t> slots(pir_encoder.slot_count());
+            for (size_t c = 0; c < db.cols; ++c) {
+                for (size_t r = 0; r < db.rows; ++r) {
+                    size_t p = r * db.cols + c;
+                    if (p >= db.num_plaintexts) {
+                        out.put(0);
+                        continue;
+                    }
+                    readPlaintextBytes(in, db, p, bytes);
+                    for (size_t k = 0; k < slots.size(); ++k) {
+                        slots[k] = bytes[2 * k] | (static_cast<uint64_t>(bytes[2 * k + 1]) << 8);
+                    }
+                    // Fresh plaintext each time: BatchEncoder::encode cannot resize one left in NTT form
+                    Plaintext plain;
+                    pir_encoder.encode(slots, plain);
+
+                    // An all-zero plaintext would make multiply_plain return a transparent ciphertext
+                    if (plain.is_zero()) {
+                        out.put(0);
+                        continue;
+                    }
+                    pir_evaluator.transform_to_ntt_inplace(plain, pir_context.first_parms_id());
+                    out.put(1);
+                    plain.save(out, compr_mode_type::none);
+                }
+            }
+            db.cache_bytes = static_cast<size_t>(out.tellp());
+            out.seekp(0);
+            writeCacheHeader(out, db);
+            out.close();
+            if (!out) {
+                throw std::runtime_error("SEAL_PIR: failed writing cache " + tmp_path);
+            }
+            std::remove(db.cache_path.c_str());
+            if (std::rename(tmp_path.c_str(), db.cache_path.c_str()) != 0) {
+                throw std::runtime_error("SEAL_PIR: could not rename " + tmp_path + " to " + db.cache_path);
+            }
+        } catch (...) {
+            if (out.is_open()) {
+                out.close();
+            }
+            std::remove(tmp_path.c_str());
+            throw;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        log_stream << "   Preprocessing completed in " << duration.count() << " ms ("
+                   << db.cache_bytes << " cache bytes)" << std::endl;
+        return db;
+    }
+
+    /**
+     * Client: creates the Galois keys for oblivious expansion and the relinearization keys
+     * for the second dimension, serialized as they would be sent to the server.
+     */
+    std::string generateServerKeys(const Database& db) {
+        std::vector<uint32_t> galois_elts;
+        size_t n = pir_parms.poly_modulus_degree();
+        for (size_t k = 1; k < db.expansion_size; k <<= 1) {
+            galois_elts.push_back(static_cast<uint32_t>(n / k + 1));
+        }
+
+        std::stringstream stream;
+        pir_keygen.create_galois_keys(galois_elts).save(stream);
+        pir_keygen.create_relin_keys().save(stream);
+        return stream.str();
+    }
+
+    // Server: installs the keys received from the client
+    void loadServerKeys(const std::string& key_bytes) {
+        std::stringstream stream(key_bytes);
+        pir_galois_keys.load(pir_context, stream);
+        pir_relin_keys.load(pir_context, stream);
+    }
+
+    /**
+     * Client: encodes the selection vector for record_index as coefficients of one plaintext.
+     * Coefficient row is the row selector and rows + col the column selector; both are
+     * scaled by 1/expansion_size mod t to cancel the factor introduced by expansion.
+     */
+    std::string generateQuery(const Database& db, size_t record_index) {
+        if (record_index >= db.num_records) {
+            throw std::invalid_argument("SEAL_PIR: record index out of range");
+        }
+        size_t p = record_index / db.records_per_plaintext;
+        size_t row = p / db.cols;
+        size_t col = p % db.cols;
+
+        uint64_t t = pir_parms.plain_modulus().value();
+        uint64_t inv_m = powMod(db.expansion_size % t, t - 2, t);
+
+        Plaintext query(pir_parms.poly_modulus_degree());
+        query[row] = inv_m;
+        query[db.rows + col] = inv_m;
+
+        std::stringstream stream;
+        pir_encryptor->encrypt_symmetric(query).save(stream);
+        return stream.str();
+    }
+
+    // Server: answers a serialized query with a single serialized ciphertext
+    std::string answerQuery(const Database& db, const std::string& query_bytes) {
+        std::stringstream query_stream(query_bytes);
+        Ciphertext query;
+        query.load(pir_context, query_stream);
+
+        std::vector<Ciphertext> selectors = expandQuery(query, db.expansion_size, db.rows + db.cols);
+        for (size_t r = 0; r < db.rows; ++r) {
+            pir_evaluator.transform_to_ntt_inplace(selectors[r]);
+        }
+
+        std::ifstream cache(db.cache_path, std::ios::binary);
+        if (!cache.is_open() || !skipCacheHeader(cache)) {
+            throw std::runtime_error("SEAL_PIR: could not open cache " + db.cache_path);
+        }
+
+        // First dimension selects the row inside each column, second dimension selects the column
+        Ciphertext reply;
+        bool has_reply = false;
+        std::vector<Ciphertext> products;
+        Plaintext plain;
+        for (size_t c = 0; c < db.cols; ++c) {
+            products.clear();
+            for (size_t r = 0; r < db.rows; ++r) {
+                // 0 marks a missing or all-zero plaintext, 1 a stored one; anything else is corruption
+                int marker = cache.get();
+                if (marker == 0) {
+                    continue;
+                }
+                if (marker != 1) {
+                    throw std::runtime_error("SEAL_PIR: corrupt or truncated cache " + db.cache_path);
+                }
+                plain.load(pir_context, cache);
+                if (!cache) {
+                    throw std::runtime_error("SEAL_PIR: failed reading plaintext from cache " + db.cache_path);
+                }
+                products.emplace_back();
+                pir_evaluator.multiply_plain(selectors[r], plain, products.back());
+            }
+            if (products.empty()) {
+                continue;
+            }
+
+            Ciphertext column;
+            pir_evaluator.add_many(products, column);
+            pir_evaluator.transform_from_ntt_inplace(column);
+            pir_evaluator.multiply_inplace(column, selectors[db.rows + c]);
+            if (has_reply) {
+                pir_evaluator.add_inplace(reply, column);
+            } else {
+                reply = std::move(column);
+                has_reply = true;
+            }
+        }
+        if (!has_reply) {
+            throw std::runtime_error("SEAL_PIR: database contains no non-zero plaintexts");
+        }
+
+        // Stop one level above the last: with a single 43-bit prime left, the mod-switch rounding
+        // noise after the ciphertext multiply is too close to q/t to guarantee a positive budget
+        pir_evaluator.relinearize_inplace(reply, pir_relin_keys);
+        pir_evaluator.mod_switch_to_inplace(reply, replyParmsId());
+
+        std::stringstream reply_stream;
+        reply.save(reply_stream);
+        return reply_stream.str();
+    }
+
+    // Client: decrypts the reply and extracts the bytes of record_index
+    std::vector<unsigned char> decodeReply(const Database& db, const std::string& reply_bytes,
+                                           size_t record_index, int* noise_budget = nullptr) {
+        std::stringstream stream(reply_bytes);
+        Ciphertext reply;
+        reply.load(pir_context, stream);
+        if (noise_budget) {
+            *noise_budget = pir_decryptor.invariant_noise_budget(reply);
+        }
+
+        Plaintext plain;
+        std::vector<uint64_t> slots;
+        pir_decryptor.decrypt(reply, plain);
+        pir_encoder.decode(plain, slots);
+
+        size_t offset = (record_index % db.records_per_plaintext) * db.record_size;
+        std::vector<unsigned char> record(db.record_size);
+        for (size_t k = 0; k < db.record_size; ++k) {
+            uint64_t slot = slots[(offset + k) / 2];
+            record[k] = static_cast<unsigned char>(((offset + k) % 2 == 0) ? (slot & 0xFF) : (slot >> 8));
+        }
+        return record;
+    }
+
+    /**
+     * Runs one query per database size (in MB) and logs query latency, server CPU time and
+     * query/response sizes. Database files are generated with random content if missing.
+     * Returns false if any retrieval failed verification.
+     */
+    bool benchmarkPIR(const std::vector<size_t>& db_sizes_mb, size_t record_size) {
+        log_stream << "\n" << std::string(60, '=') << std::endl;
+        log_stream << "BFV PIR Server Benchmark" << std::endl;
+        log_stream << std::string(60, '=') << std::endl;
+        log_stream << "   Record size: " << record_size << " bytes, "
+                   << pir_encoder.slot_count() * 2 << " bytes per plaintext" << std::endl;
+
+        bool all_passed = true;
+        for (size_t mb : db_sizes_mb) {
+            log_stream << "\nDatabase: " << mb << " MB" << std::endl;
+            all_passed = runQuery(ensureDatabaseFile(mb * 1024 * 1024), record_size) && all_passed;
+        }
+        return all_passed;
+    }
+
+    /**
+     * Exercises layouts the power-of-two benchmark never hits: record sizes that leave the
+     * last slots of each plaintext empty, and databases that end partway through a record
+     * and a plaintext. Returns false if any retrieval failed verification.
+     */
+    bool checkPIRLayouts() {
+        log_stream << "\n" << std::string(60, '=') << std::endl;
+        log_stream << "BFV PIR Layout Checks" << std::endl;
+        log_stream << std::string(60, '=') << std::endl;
+
+        const std::vector<std::pair<size_t, size_t>> cases = {
+            { 1024 * 1024, 300 },          // 300 does not divide 16384
+            { 1024 * 1024 + 12345, 256 },  // last plaintext partially filled
+            { 1024 * 1024 + 777, 100 },    // both, plus a partial last record
+        };
+        bool all_passed = true;
+        for (const auto& test : cases) {
+            log_stream << "\nDatabase: " << test.first << " bytes, record size " << test.second << std::endl;
+            all_passed = runQuery(ensureDatabaseFile(test.first), test.second) && all_passed;
+        }
+        return all_passed;
+    }
+
+private:
+    // Preprocesses db_path, answers one query for a random record and logs the measurements
+    bool runQuery(const std::string& db_path, size_t record_size) {
+        Database db = preprocessDatabase(db_path, record_size);
+        log_stream << "   Layout: " << db.num_records << " records, " << db.num_plaintexts
+                   << " plaintexts, " << db.rows << " x " << db.cols << " grid" << std::endl;
+
+        std::string key_bytes = generateServerKeys(db);
+        loadServerKeys(key_bytes);
+        log_stream << "   Galois + relin key size: " << key_bytes.size() << " bytes (one-time)" << std::endl;
+
+        std::mt19937_64 rng(std::random_device{}());
+        size_t record_index = std::uniform_int_distribution<size_t>(0, db.num_records - 1)(rng);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::string query_bytes = generateQuery(db, record_index);
+
+        std::clock_t cpu_start = std::clock();
+        auto server_start = std::chrono::high_resolution_clock::now();
+        std::string reply_bytes = answerQuery(db, query_bytes);
+        auto server_end = std::chrono::high_resolution_clock::now();
+        std::clock_t cpu_end = std::clock();
+
+        int noise_budget = 0;
+        std::vector<unsigned char> record = decodeReply(db, reply_bytes, record_index, &noise_budget);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        auto server_wall = std::chrono::duration_cast<std::chrono::milliseconds>(server_end - server_start);
+        double server_cpu = 1000.0 * static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+
+        log_stream << "   Record index: " << record_index << std::endl;
+        log_stream << "   Query latency: " << latency.count() << " ms" << std::endl;
+        log_stream << "   Server time: " << server_wall.count() << " ms wall, "
+                   << std::fixed << std::setprecision(1) << server_cpu << " ms CPU" << std::endl;
+        log_stream << "   Query size: " << query_bytes.size() << " bytes" << std::endl;
+        log_stream << "   Response size: " << reply_bytes.size() << " bytes" << std::endl;
+        log_stream << "   Reply noise budget: " << noise_budget << " bits" << std::endl;
+
+        // A non-positive budget means the answer is unreliable even if the bytes happen to match
+        bool correct = noise_budget > 0 && record == readRecord(db, record_index);
+        log_stream << "   Retrieval verification: " << (correct ? "PASS" : "FAIL") << std::endl;
+        return correct;
+    }
+
+    // Level the reply is switched to before serialization: one above the last, if there is one
+    parms_id_type replyParmsId() const {
+        auto last = pir_context.last_context_data();
+        auto above_last = last->prev_context_data();
+        return above_last ? above_last->parms_id() : last->parms_id();
+    }
+
+    /**
+     * Oblivious expansion: level j substitutes x -> x^(N/2^j + 1), which keeps coefficients at
+     * even multiples of 2^j and negates the odd ones. Sum and difference split them, and the
+     * difference is shifted down by x^(-2^j). After log2(count) levels ciphertext i encrypts
+     * count times coefficient i of the query as a constant polynomial. Only the first
+     * needed outputs are computed, since every descendant of index i has an index >= i.
+     */
+    std::vector<Ciphertext> expandQuery(const Ciphertext& query, size_t count, size_t needed) {
+        size_t n = pir_parms.poly_modulus_degree();
+        uint64_t t = pir_parms.plain_modulus().value();
+
+        std::vector<Ciphertext> expanded(count);
+        expanded[0] = query;
+        Ciphertext substituted;
+        for (size_t k = 1; k < count; k <<= 1) {
+            uint32_t galois_elt = static_cast<uint32_t>(n / k + 1);
+
+            // x^(-k) = -x^(N-k) in Z[x]/(x^N + 1)
+            Plaintext shift(n);
+            shift[n - k] = t - 1;
+
+            for (size_t a = 0; a < k && a < needed; ++a) {
+                pir_evaluator.apply_galois(expanded[a], galois_elt, pir_galois_keys, substituted);
+                if (a + k < needed) {
+                    pir_evaluator.sub(expanded[a], substituted, expanded[a + k]);
+                    pir_evaluator.multiply_plain_inplace(expanded[a + k], shift);
+                }
+                pir_evaluator.add_inplace(expanded[a], substituted);
+            }
+        }
+        expanded.resize(needed);
+        return expanded;
+    }
+
+    Database computeLayout(const std::string& db_path, size_t record_size) {
+        Database db;
+        db.db_path = db_path;
+        db.cache_path = db_path + ".pirdb";
+        db.db_bytes = fileSize(db_path);
+        db.record_size = record_size;
+
+        size_t capacity = pir_encoder.slot_count() * 2;
+        if (record_size == 0 || record_size > capacity) {
+            throw std::invalid_argument("SEAL_PIR: record size must be between 1 and "
+                                        + std::to_string(capacity) + " bytes");
+        }
+        if (db.db_bytes == 0) {
+            throw std::invalid_argument("SEAL_PIR: database " + db_path + " is empty");
+        }
+        db.records_per_plaintext = capacity / record_size;
+        db.plaintext_bytes = db.records_per_plaintext * record_size;
+        db.num_records = (db.db_bytes + record_size - 1) / record_size;
+        db.num_plaintexts = (db.num_records + db.records_per_plaintext - 1) / db.records_per_plaintext;
+
+        db.rows = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(db.num_plaintexts))));
+        db.cols = (db.num_plaintexts + db.rows - 1) / db.rows;
+
+        db.expansion_size = 1;
+        while (db.expansion_size < db.rows + db.cols) {
+            db.expansion_size <<= 1;
+        }
+        if (db.expansion_size > pir_parms.poly_modulus_degree()) {
+            throw std::invalid_argument("SEAL_PIR: database " + db_path + " is too large for one query");
+        }
+        return db;
+    }
+
+    std::vector<uint64_t> makeCacheHeader(const Database& db) {
+        std::vector<uint64_t> header = { cache_magic, 0, 0, 0, 0, db.db_bytes, db.record_size,
+                                         db.rows, db.cols, db.content_hash, db.cache_bytes };
+        const parms_id_type& id = pir_context.first_parms_id();
+        for (size_t i = 0; i < id.size(); ++i) {
+            header[1 + i] = id[i];
+        }
+        return header;
+    }
+
+    void writeCacheHeader(std::ostream& out, const Database& db) {
+        std::vector<uint64_t> header = makeCacheHeader(db);
+        out.write(reinterpret_cast<const char*>(header.data()),
+                  static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+    }
+
+    // Accepts the cache only if every header word matches and the file has the recorded length
+    bool loadCacheHeader(Database& db) {
+        std::ifstream in(db.cache_path, std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+        std::vector<uint64_t> header(cache_header_words, 0);
+        in.read(reinterpret_cast<char*>(header.data()),
+                static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+        if (!in) {
+            return false;
+        }
+        size_t cache_bytes = fileSize(db.cache_path);
+        Database expected = db;
+        expected.cache_bytes = cache_bytes;
+        if (header != makeCacheHeader(expected)) {
+            return false;
+        }
+        db.cache_bytes = cache_bytes;
+        return true;
+    }
+
+    static bool skipCacheHeader(std::istream& in) {
+        std::vector<uint64_t> header(cache_header_words, 0);
+        in.read(reinterpret_cast<char*>(header.data()),
+                static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+        return in && header[0] == cache_magic;
+    }
+
+    // FNV-1a over the database file, so a replaced file of the same size invalidates the cache
+    static uint64_t hashFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("SEAL_PIR: could not open " + path);
+        }
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        std::vector<char> chunk(1 << 20);
+        while (in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            std::streamsize n = in.gcount();
+            for (std::streamsize i = 0; i < n; ++i) {
+                hash ^= static_cast<unsigned char>(chunk[i]);
+                hash *= 0x100000001b3ULL;
+            }
+        }
+        return hash;
+    }
+
+    // Reads plaintext p from the database file, zero-padding past plaintext_bytes and the end of the file
+    static void readPlaintextBytes(std::ifstream& in, const Database& db, size_t p,
+                                   std::vector<unsigned char>& bytes) {
+        std::fill(bytes.begin(), bytes.end(), 0);
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(p * db.plaintext_bytes));
+        in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(db.plaintext_bytes));
+    }
+
+    // Plain lookup used to verify the PIR answer
+    static std::vector<unsigned char> readRecord(const Database& db, size_t record_index) {
+        std::vector<unsigned char> record(db.record_size, 0);
+        std::ifstream in(db.db_path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(record_index * db.record_size));
+        in.read(reinterpret_cast<char*>(record.data()), static_cast<std::streamsize>(db.record_size));
+        return record;
+    }
+
+    static std::string ensureDatabaseFile(size_t bytes) {
+        const size_t mb = 1024 * 1024;
+        std::string path = (bytes % mb == 0) ? "pir_db_" + std::to_string(bytes / mb) + "MB.bin"
+                                             : "pir_db_" + std::to_string(bytes) + "B.bin";
+        if (fileSize(path) == bytes) {
+            return path;
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("SEAL_PIR: could not create " + path);
+        }
+        std::mt19937_64 rng(bytes);
+        std::vector<uint64_t> chunk(1 << 16);
+        for (size_t written = 0; written < bytes; written += chunk.size() * sizeof(uint64_t)) {
+            for (uint64_t& word : chunk) {
+                word = rng();
+            }
+            size_t n = std::min(bytes - written, chunk.size() * sizeof(uint64_t));
+            out.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(n));
+        }
+        return path;
+    }
+
+    static size_t fileSize(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) {
+            return 0;
+        }
+        return static_cast<size_t>(in.tellg());
+    }
+
+    static uint64_t powMod(uint64_t base, uint64_t exp, uint64_t mod) {
+        uint64_t result = 1;
+        base %= mod;
+        while (exp > 0) {
+            if (exp & 1) {
+                result = result * base % mod;
+            }
+            base = base * base % mod;
+            exp >>= 1;
+        }
+        return result;
+    }
+};
+
+#endif
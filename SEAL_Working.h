@@ -9,9 +9,13 @@
 #include <optional>
 #include <sstream>
 #include <fstream> // <-- ADDED for file output
+#include <algorithm>
+#include <random>
+#include <thread>
 
 // Includes are now active
 #include "seal/seal.h"
+#include "SEAL_EncryptionPool.h"
 using namespace seal;
 
 /**
@@ -531,7 +535,136 @@ public:
         }
     }
 
+    /**
+     * Compares encryption latency with and without an EncryptionPool under bursty load:
+     * `bursts` rounds of `burst_size` back-to-back encode+encrypt calls separated by
+     * `idle_ms` of idle time, during which the pool refills in the background.
+     * Returns false if any pooled encryption failed to decrypt correctly.
+     */
+    bool benchmarkEncryptionPool(size_t depth, size_t bursts, size_t burst_size, size_t idle_ms) {
+        log_stream << "\n" << std::string(60, '=') << std::endl;
+        log_stream << "Encryption-of-Zero Pool Benchmark" << std::endl;
+        log_stream << std::string(60, '=') << std::endl;
+        log_stream << "   Pool depth: " << depth << ", " << bursts << " bursts of " << burst_size
+                   << " encryptions, " << idle_ms << " ms idle between bursts" << std::endl;
+
+        std::mt19937_64 rng(std::random_device{}());
+
+        // --- BFV ---
+        std::vector<int64_t> bfv_values(bfv_encoder.slot_count());
+        std::uniform_int_distribution<int64_t> int_dist(-1000, 1000);
+        for (int64_t& val : bfv_values) val = int_dist(rng);
+
+        log_stream << "\nBFV:" << std::endl;
+        Plaintext bfv_ptxt;
+        Ciphertext bfv_ctxt;
+        auto bfv_online = runBurstyLoad([&] {
+            bfv_encoder.encode(bfv_values, bfv_ptxt);
+            bfv_encryptor->encrypt(bfv_ptxt, bfv_ctxt);
+        }, bursts, burst_size, idle_ms);
+        logLatencies("encryptor->encrypt()", bfv_online);
+
+        bool bfv_correct = false;
+        {
+            EncryptionPool bfv_pool(bfv_context, bfv_public_key, depth);
+            bfv_pool.waitUntilFull();
+            auto bfv_pooled = runBurstyLoad([&] {
+                bfv_encoder.encode(bfv_values, bfv_ptxt);
+                bfv_pool.encrypt(bfv_ptxt, bfv_ctxt);
+            }, bursts, burst_size, idle_ms);
+            logLatencies("pool encode+add_plain", bfv_pooled);
+            log_stream << "   Pool misses (synchronous fallback): " << bfv_pool.missCount() << std::endl;
+
+            Plaintext ptxt_res;
+            std::vector<int64_t> result;
+            bfv_decryptor.decrypt(bfv_ctxt, ptxt_res);
+            bfv_encoder.decode(ptxt_res, result);
+            bfv_correct = (result == bfv_values);
+            print_bfv_info(bfv_ctxt, "ctxt (pooled encryption)");
+        }
+        log_stream << "   Pooled encryption verification: " << (bfv_correct ? "PASS" : "FAIL") << std::endl;
+
+        // --- CKKS ---
+        std::vector<double> ckks_values(ckks_encoder.slot_count());
+        std::uniform_real_distribution<double> real_dist(-100.0, 100.0);
+        for (double& val : ckks_values) val = real_dist(rng);
+
+        log_stream << "\nCKKS:" << std::endl;
+        // Fresh Plaintext per call so encode never has to resize one left in NTT form
+        Ciphertext ckks_ctxt;
+        auto ckks_online = runBurstyLoad([&] {
+            Plaintext ckks_ptxt;
+            ckks_encoder.encode(ckks_values, ckks_scale, ckks_ptxt);
+            ckks_encryptor->encrypt(ckks_ptxt, ckks_ctxt);
+        }, bursts, burst_size, idle_ms);
+        logLatencies("encryptor->encrypt()", ckks_online);
+
+        bool ckks_correct = false;
+        bool ckks_level_correct = false;
+        {
+            // Also pool the next level down, where fresh ciphertexts are smaller
+            parms_id_type lower_parms_id = ckks_context.first_context_data()->next_context_data()->parms_id();
+            EncryptionPool ckks_pool(ckks_context, ckks_public_key, depth);
+            ckks_pool.addLevel(lower_parms_id);
+            ckks_pool.waitUntilFull();
+            auto ckks_pooled = runBurstyLoad([&] {
+                Plaintext ckks_ptxt;
+                ckks_encoder.encode(ckks_values, ckks_scale, ckks_ptxt);
+                ckks_pool.encrypt(ckks_ptxt, ckks_ctxt);
+            }, bursts, burst_size, idle_ms);
+            logLatencies("pool encode+add_plain", ckks_pooled);
+            log_stream << "   Pool misses (synchronous fallback): " << ckks_pool.missCount() << std::endl;
+
+            Plaintext ptxt_res;
+            std::vector<double> result;
+            ckks_decryptor.decrypt(ckks_ctxt, ptxt_res);
+            ckks_encoder.decode(ptxt_res, result);
+            ckks_correct = verifyVectors(ckks_values, result, 0.01);
+            print_ckks_info(ckks_ctxt, "ctxt (pooled encryption)");
+
+            Plaintext lower_ptxt;
+            ckks_encoder.encode(ckks_values, lower_parms_id, ckks_scale, lower_ptxt);
+            ckks_pool.encrypt(lower_ptxt, ckks_ctxt);
+            ckks_decryptor.decrypt(ckks_ctxt, ptxt_res);
+            ckks_encoder.decode(ptxt_res, result);
+            ckks_level_correct = verifyVectors(ckks_values, result, 0.01);
+            print_ckks_info(ckks_ctxt, "ctxt (pooled, lower level)");
+        }
+        log_stream << "   Pooled encryption verification: " << (ckks_correct ? "PASS" : "FAIL") << std::endl;
+        log_stream << "   Pooled lower-level verification: " << (ckks_level_correct ? "PASS" : "FAIL") << std::endl;
+        return bfv_correct && ckks_correct && ckks_level_correct;
+    }
+
 private:
+    // Runs encrypt_once in bursts and returns each call's latency in microseconds
+    template <typename EncryptFn>
+    std::vector<long long> runBurstyLoad(EncryptFn encrypt_once, size_t bursts, size_t burst_size, size_t idle_ms) {
+        std::vector<long long> latencies;
+        latencies.reserve(bursts * burst_size);
+        for (size_t b = 0; b < bursts; ++b) {
+            for (size_t i = 0; i < burst_size; ++i) {
+                auto start = std::chrono::high_resolution_clock::now();
+                encrypt_once();
+                auto end = std::chrono::high_resolution_clock::now();
+                latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+        }
+        return latencies;
+    }
+
+    void logLatencies(const std::string& name, std::vector<long long> latencies) {
+        if (latencies.empty()) return;
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) {
+            size_t index = static_cast<size_t>(std::ceil(p * latencies.size())) - 1;
+            return latencies[std::min(index, latencies.size() - 1)];
+        };
+        log_stream << "   " << std::setw(24) << std::left << (name + ":")
+                   << "p50 = " << percentile(0.50) << " us, p99 = " << percentile(0.99)
+                   << " us, max = " << latencies.back() << " us" << std::endl;
+    }
+
     // verifyVectors now logs failures to log_stream
     bool verifyVectors(const std::vector<double>& expected, const std::vector<double>& actual, double tolerance) {
         if (expected.size() > actual.size()) return false; 
@@ -1,8 +1,11 @@
 #include "SEAL_Working.h"
+#include "SEAL_PIR.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream> 
 #include <string> 
+#include <vector>
+#include <cstdlib>
 
 
 void compareProtocols(std::ostream& log_stream) {
@@ -78,7 +81,24 @@ void showInstallationInstructions(std::ostream& log_stream) {
     log_stream << "   - HElib: sudo apt install libhelib-dev" << std::endl;
 }
 
-int main() {
+// Runs the PIR layout checks, then the benchmark over 1 MB .. max_mb databases (powers of 16 MB, plus max_mb itself)
+// Returns false if any retrieval failed verification
+bool runPIRBenchmark(std::ostream& log_stream, size_t max_mb) {
+    std::vector<size_t> db_sizes_mb;
+    for (size_t mb = 1; mb < max_mb; mb *= 16) {
+        db_sizes_mb.push_back(mb);
+    }
+    db_sizes_mb.push_back(max_mb);
+
+    SEAL_PIR seal_pir(log_stream);
+    bool layouts_passed = seal_pir.checkPIRLayouts();
+    bool benchmark_passed = seal_pir.benchmarkPIR(db_sizes_mb, 256);
+    return layouts_passed && benchmark_passed;
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = (argc > 1) ? argv[1] : "";
+
     // --- MODIFICATION: Set up file output ---
     std::ofstream log_file("output_log.txt");
     if (!log_file.is_open()) {
@@ -92,6 +112,27 @@ int main() {
     // log_file << "Date: " << __DATE__ << " " << __TIME__ << std::endl;
     
     try {
+        // "pir [max_mb]" runs the non-interactive PIR server benchmark instead of the demos
+        if (mode == "pir") {
+            size_t max_mb = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1024;
+            bool passed = runPIRBenchmark(log_file, max_mb > 0 ? max_mb : 1024);
+            std::cout << "PIR benchmark finished" << (passed ? "" : " with FAILED verifications")
+                      << ". Output written to output_log.txt" << std::endl;
+            log_file.close();
+            return passed ? 0 : 1;
+        }
+
+        // "pool [depth]" compares encryption latency with and without the zero-encryption pool
+        if (mode == "pool") {
+            size_t depth = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 64;
+            SEAL_Working seal_working(log_file);
+            bool passed = seal_working.benchmarkEncryptionPool(depth > 0 ? depth : 64, 20, 32, 200);
+            std::cout << "Pool benchmark finished" << (passed ? "" : " with FAILED verifications")
+                      << ". Output written to output_log.txt" << std::endl;
+            log_file.close();
+            return passed ? 0 : 1;
+        }
+
         // --- MODIFICATION: Pass log_file to constructor ---
         SEAL_Working seal_working(log_file);
         